@@ -0,0 +1,626 @@
+/*!
+ * \file plugins/skin_layer_generator/mesh_optimizer.cpp
+ * \brief Smoothing and flipping of tetrahedral meshes with fixed interfaces
+ *
+ *  Created on: October 19, 2026
+ *      Author: agent
+ */
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace ug::skin_layer_generator;
+
+/////////////////////////////////////////////////////////
+/// TETRAHEDRONQUALITY
+/////////////////////////////////////////////////////////
+ug::number ug::skin_layer_generator::TetrahedronQuality(const vector3& p0,
+		const vector3& p1, const vector3& p2, const vector3& p3) {
+	vector3 a, b, c, n;
+	VecSubtract(a, p1, p0);
+	VecSubtract(b, p2, p0);
+	VecSubtract(c, p3, p0);
+	VecCross(n, b, c);
+	number vol = VecDot(a, n) / 6;
+
+	number sumSq = VecDistanceSq(p0, p1) + VecDistanceSq(p0, p2) + VecDistanceSq(p0, p3)
+				 + VecDistanceSq(p1, p2) + VecDistanceSq(p1, p3) + VecDistanceSq(p2, p3);
+	if (sumSq == 0) {
+		return 0;
+	}
+
+	number quality = 12 * std::pow(3 * std::fabs(vol), 2.0 / 3.0) / sumSq;
+	return vol < 0 ? -quality : quality;
+}
+
+/////////////////////////////////////////////////////////
+/// TETMESHOPTIMIZER
+/////////////////////////////////////////////////////////
+TetMeshOptimizer::TetMeshOptimizer(Grid& grid, SubsetHandler& sh) :
+	m_grid(grid), m_sh(sh), m_numFlips(0), m_minQuality(0), m_meanQuality(0) {
+}
+
+/////////////////////////////////////////////////////////
+/// FACEKEY
+/////////////////////////////////////////////////////////
+TetMeshOptimizer::FaceKey::FaceKey(int a, int b, int c) {
+	v[0] = a; v[1] = b; v[2] = c;
+	std::sort(v, v + 3);
+}
+
+/////////////////////////////////////////////////////////
+/// FACEKEY::OPERATOR<
+/////////////////////////////////////////////////////////
+bool TetMeshOptimizer::FaceKey::operator<(const FaceKey& other) const {
+	return std::lexicographical_compare(v, v + 3, other.v, other.v + 3);
+}
+
+/////////////////////////////////////////////////////////
+/// OPTIMIZE
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::optimize(size_t numIterations) {
+	collect();
+
+	update_quality();
+	UG_LOG("SkinLayerGenerator: tetrahedron quality before optimization: min "
+			<< m_minQuality << ", mean " << m_meanQuality << std::endl);
+
+	for (size_t i = 0; i < numIterations; i++) {
+		/// flips of the previous sweep change the adjacency
+		update_neighbors();
+		color();
+		for (size_t c = 0; c < m_colors.size(); c++) {
+			const std::vector<int>& vrts = m_colors[c];
+			const int numVrts = static_cast<int>(vrts.size());
+			#ifdef _OPENMP
+			#pragma omp parallel for schedule(static)
+			#endif
+			for (int j = 0; j < numVrts; j++) {
+				smooth_vertex(vrts[j]);
+			}
+		}
+		m_numFlips += flip();
+	}
+
+	write_back();
+	update_quality();
+	UG_LOG("SkinLayerGenerator: tetrahedron quality after optimization:  min "
+			<< m_minQuality << ", mean " << m_meanQuality << " ("
+			<< m_colors.size() << " colors, " << m_numFlips << " flips, "
+			<< numIterations << " sweeps)" << std::endl);
+}
+
+/////////////////////////////////////////////////////////
+/// MIN_QUALITY
+/////////////////////////////////////////////////////////
+ug::number TetMeshOptimizer::min_quality() const {
+	return m_minQuality;
+}
+
+/////////////////////////////////////////////////////////
+/// MEAN_QUALITY
+/////////////////////////////////////////////////////////
+ug::number TetMeshOptimizer::mean_quality() const {
+	return m_meanQuality;
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_COLORS
+/////////////////////////////////////////////////////////
+size_t TetMeshOptimizer::num_colors() const {
+	return m_colors.size();
+}
+
+/////////////////////////////////////////////////////////
+/// VERTICES_OF_COLOR
+/////////////////////////////////////////////////////////
+std::vector<ug::Vertex*> TetMeshOptimizer::vertices_of_color(size_t color) const {
+	UG_COND_THROW(color >= m_colors.size(), "Color " << color << " out of range, "
+			"mesh has " << m_colors.size() << " colors.");
+	std::vector<Vertex*> vrts;
+	for (size_t i = 0; i < m_colors[color].size(); i++) {
+		vrts.push_back(m_vrts[m_colors[color][i]]);
+	}
+	return vrts;
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_FLIPS
+/////////////////////////////////////////////////////////
+size_t TetMeshOptimizer::num_flips() const {
+	return m_numFlips;
+}
+
+/////////////////////////////////////////////////////////
+/// COLLECT
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::collect() {
+	m_vrts.clear(); m_pos.clear(); m_fixed.clear(); m_tets.clear();
+	m_orientation.clear(); m_vrtTets.clear(); m_vrtNbrs.clear(); m_colors.clear();
+	m_tetVols.clear(); m_tetSubset.clear(); m_alive.clear();
+	m_constrainedFaces.clear(); m_removedFaces.clear(); m_removedEdges.clear();
+	m_numFlips = 0;
+
+	Grid::VertexAttachmentAccessor<APosition> aaPos(m_grid, aPosition);
+	AInt aIndex;
+	m_grid.attach_to_vertices(aIndex);
+	Grid::VertexAttachmentAccessor<AInt> aaIndex(m_grid, aIndex);
+
+	/// vertices: those assigned to a subset stem from the input surface
+	for (VertexIterator vIter = m_grid.vertices_begin(); vIter != m_grid.vertices_end(); ++vIter) {
+		Vertex* v = *vIter;
+		aaIndex[v] = static_cast<int>(m_vrts.size());
+		m_vrts.push_back(v);
+		m_pos.push_back(aaPos[v]);
+		m_fixed.push_back(m_sh.get_subset_index(v) != -1);
+	}
+
+	/// faces: constrained faces and boundary faces fix their corners and are never flipped
+	Grid::volume_traits::secure_container vols;
+	for (FaceIterator fIter = m_grid.faces_begin(); fIter != m_grid.faces_end(); ++fIter) {
+		Face* f = *fIter;
+		m_grid.associated_elements(vols, f);
+		if (m_sh.get_subset_index(f) != -1 || vols.size() < 2) {
+			for (size_t i = 0; i < f->num_vertices(); i++) {
+				m_fixed[aaIndex[f->vertex(i)]] = true;
+			}
+			if (f->num_vertices() == 3) {
+				m_constrainedFaces.insert(FaceKey(aaIndex[f->vertex(0)], aaIndex[f->vertex(1)], aaIndex[f->vertex(2)]));
+			}
+		}
+	}
+
+	/// volumes: only tetrahedra are smoothed, corners of others stay fixed
+	m_vrtTets.resize(m_vrts.size());
+	for (VolumeIterator vIter = m_grid.volumes_begin(); vIter != m_grid.volumes_end(); ++vIter) {
+		Volume* vol = *vIter;
+		if (vol->num_vertices() != 4) {
+			for (size_t i = 0; i < vol->num_vertices(); i++) {
+				m_fixed[aaIndex[vol->vertex(i)]] = true;
+			}
+			continue;
+		}
+
+		int v[4];
+		for (size_t i = 0; i < 4; i++) {
+			v[i] = aaIndex[vol->vertex(i)];
+		}
+		add_tet(v, signed_volume(v) < 0 ? -1 : 1, m_sh.get_subset_index(vol));
+		m_tetVols.back() = vol;
+	}
+
+	m_grid.detach_from_vertices(aIndex);
+}
+
+/////////////////////////////////////////////////////////
+/// UPDATE_NEIGHBORS
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::update_neighbors() {
+	m_vrtNbrs.assign(m_vrts.size(), std::vector<int>());
+	for (size_t i = 0; i < m_vrts.size(); i++) {
+		std::vector<int>& nbrs = m_vrtNbrs[i];
+		const std::vector<int>& tets = m_vrtTets[i];
+		for (size_t j = 0; j < tets.size(); j++) {
+			for (size_t k = 0; k < 4; k++) {
+				if (m_tets[4*tets[j]+k] != static_cast<int>(i)) {
+					nbrs.push_back(m_tets[4*tets[j]+k]);
+				}
+			}
+		}
+		std::sort(nbrs.begin(), nbrs.end());
+		nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+		if (nbrs.empty()) {
+			m_fixed[i] = true;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// COLOR
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::color() {
+	m_colors.clear();
+	std::vector<int> vrtColor(m_vrts.size(), -1);
+	std::vector<bool> used;
+	for (size_t i = 0; i < m_vrts.size(); i++) {
+		if (m_fixed[i]) {
+			continue;
+		}
+
+		used.assign(m_colors.size() + 1, false);
+		const std::vector<int>& nbrs = m_vrtNbrs[i];
+		for (size_t j = 0; j < nbrs.size(); j++) {
+			if (vrtColor[nbrs[j]] != -1) {
+				used[vrtColor[nbrs[j]]] = true;
+			}
+		}
+
+		size_t c = std::find(used.begin(), used.end(), false) - used.begin();
+		if (c == m_colors.size()) {
+			m_colors.push_back(std::vector<int>());
+		}
+		vrtColor[i] = static_cast<int>(c);
+		m_colors[c].push_back(static_cast<int>(i));
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// SMOOTH_VERTEX
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::smooth_vertex(int vrt) {
+	const std::vector<int>& nbrs = m_vrtNbrs[vrt];
+	vector3 centroid(0, 0, 0);
+	for (size_t i = 0; i < nbrs.size(); i++) {
+		VecAdd(centroid, centroid, m_pos[nbrs[i]]);
+	}
+	VecScale(centroid, centroid, 1.0 / nbrs.size());
+
+	/// smart Laplacian: reject moves which worsen the local quality
+	number oldQuality = local_min_quality(vrt);
+	vector3 oldPos = m_pos[vrt];
+	m_pos[vrt] = centroid;
+	if (local_min_quality(vrt) < oldQuality) {
+		m_pos[vrt] = oldPos;
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// LOCAL_MIN_QUALITY
+/////////////////////////////////////////////////////////
+ug::number TetMeshOptimizer::local_min_quality(int vrt) const {
+	const std::vector<int>& tets = m_vrtTets[vrt];
+	number quality = std::numeric_limits<number>::max();
+	for (size_t i = 0; i < tets.size(); i++) {
+		quality = std::min(quality, tet_quality(tets[i]));
+	}
+	return quality;
+}
+
+/////////////////////////////////////////////////////////
+/// TET_QUALITY
+/////////////////////////////////////////////////////////
+ug::number TetMeshOptimizer::tet_quality(int tet) const {
+	const int* v = &m_tets[4*tet];
+	return m_orientation[tet] * TetrahedronQuality(m_pos[v[0]], m_pos[v[1]], m_pos[v[2]], m_pos[v[3]]);
+}
+
+/////////////////////////////////////////////////////////
+/// FLIP
+/////////////////////////////////////////////////////////
+size_t TetMeshOptimizer::flip() {
+	size_t numFlips = 0;
+	/// tetrahedra created by flips are appended, thus visited in the same sweep
+	for (size_t t = 0; t < m_alive.size(); t++) {
+		for (size_t i = 0; i < 4 && m_alive[t]; i++) {
+			for (size_t j = i + 1; j < 4 && m_alive[t]; j++) {
+				if (flip_32(m_tets[4*t+i], m_tets[4*t+j])) {
+					numFlips++;
+				}
+			}
+		}
+		for (size_t k = 0; k < 4 && m_alive[t]; k++) {
+			if (flip_23(static_cast<int>(t), static_cast<int>(k))) {
+				numFlips++;
+			}
+		}
+	}
+	return numFlips;
+}
+
+/////////////////////////////////////////////////////////
+/// FLIP_23
+/////////////////////////////////////////////////////////
+bool TetMeshOptimizer::flip_23(int tet, int k) {
+	/// face (a, b, c) opposite to corner d
+	const int d = m_tets[4*tet+k];
+	const int a = m_tets[4*tet+(k+1)%4];
+	const int b = m_tets[4*tet+(k+2)%4];
+	const int c = m_tets[4*tet+(k+3)%4];
+	if (is_constrained(a, b, c)) {
+		return false;
+	}
+
+	/// neighbor (a, b, c, e) across the face
+	int other = -1;
+	const std::vector<int>& tets = m_vrtTets[a];
+	for (size_t i = 0; i < tets.size(); i++) {
+		if (tets[i] != tet && contains(tets[i], b) && contains(tets[i], c)) {
+			other = tets[i];
+			break;
+		}
+	}
+	if (other == -1 || m_tetSubset[other] != m_tetSubset[tet]) {
+		return false;
+	}
+	int e = -1;
+	for (size_t i = 0; i < 4; i++) {
+		int v = m_tets[4*other+i];
+		if (v != a && v != b && v != c) {
+			e = v;
+		}
+	}
+
+	/// replacing one corner of the face by e yields the new tetrahedra, they
+	/// are valid iff they share the orientation of (a, b, c, d), i.e. iff
+	/// the new edge (d, e) pierces the face
+	const int abcd[4] = {a, b, c, d};
+	const number orientation = signed_volume(abcd);
+	if (orientation == 0) {
+		return false;
+	}
+	int newTets[3][4] = {{a, b, e, d}, {e, b, c, d}, {a, e, c, d}};
+	for (size_t i = 0; i < 3; i++) {
+		if (signed_volume(newTets[i]) * orientation <= 0) {
+			return false;
+		}
+	}
+
+	/// keep the orientation of the replaced tetrahedra
+	const number tetOrientation = m_orientation[tet];
+	if ((orientation < 0 ? -1 : 1) != tetOrientation) {
+		for (size_t i = 0; i < 3; i++) {
+			std::swap(newTets[i][0], newTets[i][1]);
+		}
+	}
+
+	number oldQuality = std::min(tet_quality(tet), tet_quality(other));
+	number newQuality = std::numeric_limits<number>::max();
+	for (size_t i = 0; i < 3; i++) {
+		const int* v = newTets[i];
+		newQuality = std::min(newQuality, tetOrientation
+				* TetrahedronQuality(m_pos[v[0]], m_pos[v[1]], m_pos[v[2]], m_pos[v[3]]));
+	}
+	if (oldQuality <= 0 || newQuality <= oldQuality) {
+		return false;
+	}
+
+	const int si = m_tetSubset[tet];
+	remove_tet(tet);
+	remove_tet(other);
+	for (size_t i = 0; i < 3; i++) {
+		add_tet(newTets[i], tetOrientation, si);
+	}
+	m_removedFaces.push_back(FaceKey(a, b, c));
+	return true;
+}
+
+/////////////////////////////////////////////////////////
+/// FLIP_32
+/////////////////////////////////////////////////////////
+bool TetMeshOptimizer::flip_32(int a, int b) {
+	/// tetrahedra around the edge
+	std::vector<int> tets;
+	const std::vector<int>& aTets = m_vrtTets[a];
+	for (size_t i = 0; i < aTets.size(); i++) {
+		if (contains(aTets[i], b)) {
+			tets.push_back(aTets[i]);
+		}
+	}
+	if (tets.size() != 3 || m_tetSubset[tets[0]] != m_tetSubset[tets[1]]
+			|| m_tetSubset[tets[0]] != m_tetSubset[tets[2]]) {
+		return false;
+	}
+
+	/// the edge is inner iff its three ring vertices are shared by two tetrahedra each
+	int ring[3];
+	size_t numInRing[3] = {0, 0, 0};
+	size_t ringSize = 0;
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 4; j++) {
+			int v = m_tets[4*tets[i]+j];
+			if (v == a || v == b) {
+				continue;
+			}
+			size_t r = std::find(ring, ring + ringSize, v) - ring;
+			if (r == ringSize) {
+				if (ringSize == 3) {
+					return false;
+				}
+				ring[ringSize++] = v;
+			}
+			numInRing[r]++;
+		}
+	}
+	if (ringSize != 3 || numInRing[0] != 2 || numInRing[1] != 2 || numInRing[2] != 2) {
+		return false;
+	}
+	for (size_t i = 0; i < 3; i++) {
+		if (is_constrained(a, b, ring[i])) {
+			return false;
+		}
+	}
+
+	/// the new tetrahedra are valid iff the edge pierces the ring's triangle,
+	/// i.e. iff a and b are on opposite sides and no volume is gained or lost
+	int newTets[2][4] = {{ring[0], ring[1], ring[2], a}, {ring[0], ring[1], ring[2], b}};
+	const number volA = signed_volume(newTets[0]);
+	const number volB = signed_volume(newTets[1]);
+	if (volA * volB >= 0) {
+		return false;
+	}
+	number oldVolume = 0;
+	for (size_t i = 0; i < 3; i++) {
+		oldVolume += std::fabs(signed_volume(&m_tets[4*tets[i]]));
+	}
+	if (std::fabs(std::fabs(volA) + std::fabs(volB) - oldVolume) > 1e-10 * oldVolume) {
+		return false;
+	}
+
+	/// keep the orientation of the replaced tetrahedra
+	const number orientation = m_orientation[tets[0]];
+	if ((volA < 0 ? -1 : 1) != orientation) {
+		std::swap(newTets[0][0], newTets[0][1]);
+	}
+	if ((volB < 0 ? -1 : 1) != orientation) {
+		std::swap(newTets[1][0], newTets[1][1]);
+	}
+
+	number oldQuality = std::numeric_limits<number>::max();
+	for (size_t i = 0; i < 3; i++) {
+		oldQuality = std::min(oldQuality, tet_quality(tets[i]));
+	}
+	number newQuality = std::numeric_limits<number>::max();
+	for (size_t i = 0; i < 2; i++) {
+		const int* v = newTets[i];
+		newQuality = std::min(newQuality, orientation
+				* TetrahedronQuality(m_pos[v[0]], m_pos[v[1]], m_pos[v[2]], m_pos[v[3]]));
+	}
+	if (oldQuality <= 0 || newQuality <= oldQuality) {
+		return false;
+	}
+
+	const int si = m_tetSubset[tets[0]];
+	for (size_t i = 0; i < 3; i++) {
+		remove_tet(tets[i]);
+		m_removedFaces.push_back(FaceKey(a, b, ring[i]));
+	}
+	for (size_t i = 0; i < 2; i++) {
+		add_tet(newTets[i], orientation, si);
+	}
+	m_removedEdges.push_back(std::make_pair(a, b));
+	return true;
+}
+
+/////////////////////////////////////////////////////////
+/// CONTAINS
+/////////////////////////////////////////////////////////
+bool TetMeshOptimizer::contains(int tet, int vrt) const {
+	const int* v = &m_tets[4*tet];
+	return v[0] == vrt || v[1] == vrt || v[2] == vrt || v[3] == vrt;
+}
+
+/////////////////////////////////////////////////////////
+/// IS_CONSTRAINED
+/////////////////////////////////////////////////////////
+bool TetMeshOptimizer::is_constrained(int a, int b, int c) const {
+	return m_constrainedFaces.find(FaceKey(a, b, c)) != m_constrainedFaces.end();
+}
+
+/////////////////////////////////////////////////////////
+/// SIGNED_VOLUME
+/////////////////////////////////////////////////////////
+ug::number TetMeshOptimizer::signed_volume(const int* v) const {
+	vector3 a, b, c, n;
+	VecSubtract(a, m_pos[v[1]], m_pos[v[0]]);
+	VecSubtract(b, m_pos[v[2]], m_pos[v[0]]);
+	VecSubtract(c, m_pos[v[3]], m_pos[v[0]]);
+	VecCross(n, b, c);
+	return VecDot(a, n) / 6;
+}
+
+/////////////////////////////////////////////////////////
+/// ADD_TET
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::add_tet(const int* v, number orientation, int si) {
+	const int tet = static_cast<int>(m_alive.size());
+	m_tets.insert(m_tets.end(), v, v + 4);
+	m_orientation.push_back(orientation);
+	m_tetVols.push_back(NULL);
+	m_tetSubset.push_back(si);
+	m_alive.push_back(true);
+	for (size_t i = 0; i < 4; i++) {
+		m_vrtTets[v[i]].push_back(tet);
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// REMOVE_TET
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::remove_tet(int tet) {
+	m_alive[tet] = false;
+	for (size_t i = 0; i < 4; i++) {
+		std::vector<int>& tets = m_vrtTets[m_tets[4*tet+i]];
+		tets.erase(std::find(tets.begin(), tets.end(), tet));
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// UPDATE_QUALITY
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::update_quality() {
+	number minQuality = std::numeric_limits<number>::max();
+	number sumQuality = 0;
+	size_t numTets = 0;
+	for (size_t i = 0; i < m_alive.size(); i++) {
+		if (m_alive[i]) {
+			number quality = tet_quality(static_cast<int>(i));
+			minQuality = std::min(minQuality, quality);
+			sumQuality += quality;
+			numTets++;
+		}
+	}
+
+	if (numTets == 0) {
+		m_minQuality = m_meanQuality = 0;
+		return;
+	}
+	m_minQuality = minQuality;
+	m_meanQuality = sumQuality / numTets;
+}
+
+/////////////////////////////////////////////////////////
+/// WRITE_BACK
+/////////////////////////////////////////////////////////
+void TetMeshOptimizer::write_back() {
+	Grid::VertexAttachmentAccessor<APosition> aaPos(m_grid, aPosition);
+	for (size_t i = 0; i < m_vrts.size(); i++) {
+		aaPos[m_vrts[i]] = m_pos[i];
+	}
+
+	/// sides removed by flips, looked up before the grid changes (sides
+	/// created and removed again by later flips never reached the grid)
+	std::vector<Face*> faces;
+	for (size_t i = 0; i < m_removedFaces.size(); i++) {
+		const int* v = m_removedFaces[i].v;
+		FaceDescriptor fd(m_vrts[v[0]], m_vrts[v[1]], m_vrts[v[2]]);
+		Face* f = m_grid.get_face(fd);
+		if (f) {
+			faces.push_back(f);
+		}
+	}
+	std::vector<Edge*> edges;
+	for (size_t i = 0; i < m_removedEdges.size(); i++) {
+		Edge* e = m_grid.get_edge(m_vrts[m_removedEdges[i].first], m_vrts[m_removedEdges[i].second]);
+		if (e) {
+			edges.push_back(e);
+		}
+	}
+
+	/// replace flipped tetrahedra
+	for (size_t i = 0; i < m_alive.size(); i++) {
+		if (!m_alive[i] && m_tetVols[i]) {
+			m_grid.erase(m_tetVols[i]);
+			m_tetVols[i] = NULL;
+		}
+	}
+	for (size_t i = 0; i < m_alive.size(); i++) {
+		if (m_alive[i] && !m_tetVols[i]) {
+			const int* v = &m_tets[4*i];
+			Volume* vol = *m_grid.create<Tetrahedron>(TetrahedronDescriptor(m_vrts[v[0]], m_vrts[v[1]], m_vrts[v[2]], m_vrts[v[3]]));
+			m_sh.assign_subset(vol, m_tetSubset[i]);
+			m_tetVols[i] = vol;
+		}
+	}
+
+	/// erase removed sides no longer used by any tetrahedron
+	std::sort(faces.begin(), faces.end());
+	faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+	Grid::volume_traits::secure_container vols;
+	for (size_t i = 0; i < faces.size(); i++) {
+		m_grid.associated_elements(vols, faces[i]);
+		if (vols.size() == 0) {
+			m_grid.erase(faces[i]);
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	Grid::face_traits::secure_container edgeFaces;
+	for (size_t i = 0; i < edges.size(); i++) {
+		m_grid.associated_elements(edgeFaces, edges[i]);
+		m_grid.associated_elements(vols, edges[i]);
+		if (edgeFaces.size() == 0 && vols.size() == 0) {
+			m_grid.erase(edges[i]);
+		}
+	}
+}
@@ -0,0 +1,187 @@
+/*!
+ * \file plugins/skin_layer_generator/mesh_optimizer.h
+ * \brief Smoothing and flipping of tetrahedral meshes with fixed interfaces
+ *
+ *  Created on: October 19, 2026
+ *      Author: agent
+ */
+#ifndef __H__UG__SKIN_LAYER_GENERATOR__MESH_OPTIMIZER__
+#define __H__UG__SKIN_LAYER_GENERATOR__MESH_OPTIMIZER__
+
+#include <set>
+#include <utility>
+#include <vector>
+#include "lib_grid/lib_grid.h"
+
+namespace ug {
+	namespace skin_layer_generator {
+		/*!
+		 * \brief mean ratio quality of a tetrahedron
+		 *
+		 * Yields 1 for a regular tetrahedron, tends to 0 for degenerated ones
+		 * and is negative for negatively oriented (inverted) tetrahedra.
+		 *
+		 * \param[in] p0 first corner
+		 * \param[in] p1 second corner
+		 * \param[in] p2 third corner
+		 * \param[in] p3 fourth corner
+		 */
+		number TetrahedronQuality(const vector3& p0, const vector3& p1,
+								  const vector3& p2, const vector3& p3);
+
+		/*!
+		 * \brief TetMeshOptimizer
+		 *
+		 * Smart Laplacian smoothing of the inner vertices of a tetrahedral
+		 * mesh followed by 2-3 and 3-2 flips. Vertices of faces assigned to
+		 * a subset (layer interfaces, depot boundary, outer surface) and
+		 * vertices on the boundary stay fixed. A vertex is only moved if the
+		 * minimal quality of its adjacent tetrahedra does not decrease. Free
+		 * vertices are colored such that vertices of the same color do not
+		 * share a tetrahedron, thus each color can be smoothed in parallel
+		 * (if built with OpenMP). Flips are done serially, they never remove
+		 * a face assigned to a subset or on the boundary, only replace
+		 * tetrahedra of the same subset and are only done if they raise the
+		 * minimal quality of the tetrahedra involved.
+		 */
+		class TetMeshOptimizer {
+		public:
+			/*!
+			 * \brief construct an optimizer for the given grid
+			 *
+			 * \param[in] grid
+			 * \param[in] sh subset handler marking the constrained faces
+			 */
+			TetMeshOptimizer(Grid& grid, SubsetHandler& sh);
+
+			/*!
+			 * \brief smooth and flip, report quality before and after
+			 *
+			 * \param[in] numIterations number of smoothing and flip sweeps
+			 */
+			void optimize(size_t numIterations);
+
+			/*!
+			 * \brief minimal tetrahedron quality of the last optimization
+			 */
+			number min_quality() const;
+
+			/*!
+			 * \brief mean tetrahedron quality of the last optimization
+			 */
+			number mean_quality() const;
+
+			/*!
+			 * \brief number of colors used for the last optimization
+			 */
+			size_t num_colors() const;
+
+			/*!
+			 * \brief vertices of one color of the last optimization
+			 * \param[in] color
+			 */
+			std::vector<Vertex*> vertices_of_color(size_t color) const;
+
+			/*!
+			 * \brief number of flips done by the last optimization
+			 */
+			size_t num_flips() const;
+
+		private:
+			/*!
+			 * \brief vertex indices of a face, sorted to identify it
+			 */
+			struct FaceKey {
+				int v[3];
+
+				/*!
+				 * \brief construct the key of the face (a, b, c)
+				 */
+				FaceKey(int a, int b, int c);
+
+				bool operator<(const FaceKey& other) const;
+			};
+
+		private:
+			/// copy the grid into flat arrays (not thread-safe, done serially)
+			void collect();
+
+			/// adjacent vertices of each vertex from the current tetrahedra
+			void update_neighbors();
+
+			/// greedy coloring of the free vertices
+			void color();
+
+			/// move a single vertex to its neighbor's centroid if quality allows
+			void smooth_vertex(int vrt);
+
+			/// minimal quality of the tetrahedra adjacent to a vertex
+			number local_min_quality(int vrt) const;
+
+			/// oriented quality of a single tetrahedron
+			number tet_quality(int tet) const;
+
+			/// one sweep of 2-3 and 3-2 flips over all tetrahedra, returns the number of flips
+			size_t flip();
+
+			/// replace a tetrahedron and its neighbor across the face opposite
+			/// to corner k by three tetrahedra around a new edge
+			bool flip_23(int tet, int k);
+
+			/// replace the three tetrahedra around edge (a, b) by two
+			bool flip_32(int a, int b);
+
+			/// check if a tetrahedron contains a vertex
+			bool contains(int tet, int vrt) const;
+
+			/// check if a face is assigned to a subset or on the boundary
+			bool is_constrained(int a, int b, int c) const;
+
+			/// signed volume of the tetrahedron with the given corners
+			number signed_volume(const int* v) const;
+
+			/// append a tetrahedron, its corners must have the given orientation
+			void add_tet(const int* v, number orientation, int si);
+
+			/// remove a tetrahedron from the mesh
+			void remove_tet(int tet);
+
+			/// compute min and mean quality of all tetrahedra
+			void update_quality();
+
+			/// write the smoothed positions and the flipped tetrahedra back to the grid
+			void write_back();
+
+		private:
+			Grid& m_grid;
+			SubsetHandler& m_sh;
+
+			/// flat copy of the grid
+			std::vector<Vertex*> m_vrts;
+			std::vector<vector3> m_pos;
+			std::vector<bool> m_fixed;
+			std::vector<int> m_tets;
+			std::vector<number> m_orientation;
+			std::vector<std::vector<int> > m_vrtTets;
+			std::vector<std::vector<int> > m_vrtNbrs;
+			std::vector<std::vector<int> > m_colors;
+
+			/// tetrahedra: grid element (NULL if created by a flip), subset, alive
+			std::vector<Volume*> m_tetVols;
+			std::vector<int> m_tetSubset;
+			std::vector<bool> m_alive;
+
+			/// faces which must not be flipped, faces and edges removed by flips
+			std::set<FaceKey> m_constrainedFaces;
+			std::vector<FaceKey> m_removedFaces;
+			std::vector<std::pair<int, int> > m_removedEdges;
+			size_t m_numFlips;
+
+			/// quality measures
+			number m_minQuality;
+			number m_meanQuality;
+		};
+	}
+}
+
+#endif // __H__UG__SKIN_LAYER_GENERATOR__MESH_OPTIMIZER__
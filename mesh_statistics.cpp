@@ -0,0 +1,259 @@
+/*!
+ * \file plugins/skin_layer_generator/mesh_statistics.cpp
+ * \brief Per-subset statistics of a generated mesh
+ *
+ *  Created on: October 19, 2026
+ *      Author: agent
+ */
+#include "mesh_statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace ug::skin_layer_generator;
+
+namespace {
+	/*!
+	 * \brief largest distance between two corners of an element
+	 *
+	 * \param[in] elem
+	 * \param[in] aaPos
+	 */
+	template <class TElem>
+	ug::number ElementSize(TElem* elem, ug::Grid::VertexAttachmentAccessor<ug::APosition>& aaPos) {
+		ug::number sizeSq = 0;
+		for (size_t i = 0; i < elem->num_vertices(); i++) {
+			for (size_t j = i + 1; j < elem->num_vertices(); j++) {
+				sizeSq = std::max(sizeSq, ug::VecDistanceSq(aaPos[elem->vertex(i)], aaPos[elem->vertex(j)]));
+			}
+		}
+		return std::sqrt(sizeSq);
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// MESHSTATISTICS
+/////////////////////////////////////////////////////////
+MeshStatistics::MeshStatistics(Grid& grid, SubsetHandler& sh) {
+	/// associations are read concurrently, thus they must not be built lazily
+	grid.enable_options(VOLOPT_STORE_ASSOCIATED_FACES | FACEOPT_STORE_ASSOCIATED_VOLUMES);
+
+	const int numSubsets = sh.num_subsets();
+	m_subsets.resize(numSubsets);
+	for (int si = 0; si < numSubsets; si++) {
+		SubsetStatistics& stats = m_subsets[si];
+		stats.name = sh.subset_info(si).name;
+		stats.numVertices = sh.num<Vertex>(si);
+		stats.numEdges = sh.num<Edge>(si);
+		stats.numFaces = sh.num<Face>(si);
+		stats.numVolumes = sh.num<Volume>(si);
+		stats.minElementSize = std::numeric_limits<number>::max();
+	}
+
+	/// sizes are measured on the highest dimensional elements of a subset,
+	/// edges are only needed for subsets without faces and volumes
+	bool hasEdgeSubsets = false;
+	for (int si = 0; si < numSubsets; si++) {
+		hasEdgeSubsets |= m_subsets[si].numVolumes == 0 && m_subsets[si].numFaces == 0
+						  && m_subsets[si].numEdges > 0;
+	}
+	std::vector<Volume*> vols(grid.volumes_begin(), grid.volumes_end());
+	std::vector<Face*> faces(grid.faces_begin(), grid.faces_end());
+	std::vector<Edge*> edges;
+	if (hasEdgeSubsets) {
+		edges.assign(grid.edges_begin(), grid.edges_end());
+	}
+	const int numVols = static_cast<int>(vols.size());
+	const int numFaces = static_cast<int>(faces.size());
+	const int numEdges = static_cast<int>(edges.size());
+
+	/// one pass over all elements, each thread accumulates all subsets and
+	/// its partial results are merged once at the end
+	Grid::VertexAttachmentAccessor<APosition> aaPos(grid, aPosition);
+	#ifdef _OPENMP
+	#pragma omp parallel
+	#endif
+	{
+		std::vector<SubsetStatistics> partial(numSubsets);
+		for (int si = 0; si < numSubsets; si++) {
+			partial[si].minElementSize = std::numeric_limits<number>::max();
+		}
+		Grid::face_traits::secure_container sides;
+		Grid::volume_traits::secure_container nbrs;
+
+		#ifdef _OPENMP
+		#pragma omp for schedule(static) nowait
+		#endif
+		for (int i = 0; i < numVols; i++) {
+			Volume* vol = vols[i];
+			const int si = sh.get_subset_index(vol);
+			if (si < 0) {
+				continue;
+			}
+			SubsetStatistics& stats = partial[si];
+			stats.volume += CalculateVolume(vol, aaPos);
+			number size = ElementSize(vol, aaPos);
+			stats.minElementSize = std::min(stats.minElementSize, size);
+			stats.maxElementSize = std::max(stats.maxElementSize, size);
+
+			/// a side is on the boundary if no other volume of the subset shares it
+			grid.associated_elements(sides, vol);
+			for (size_t j = 0; j < sides.size(); j++) {
+				grid.associated_elements(nbrs, sides[j]);
+				size_t numInSubset = 0;
+				for (size_t k = 0; k < nbrs.size(); k++) {
+					if (sh.get_subset_index(nbrs[k]) == si) {
+						numInSubset++;
+					}
+				}
+				if (numInSubset == 1) {
+					stats.boundaryArea += FaceArea(sides[j], aaPos);
+				}
+			}
+		}
+
+		/// faces count for subsets without volumes only
+		#ifdef _OPENMP
+		#pragma omp for schedule(static) nowait
+		#endif
+		for (int i = 0; i < numFaces; i++) {
+			Face* f = faces[i];
+			const int si = sh.get_subset_index(f);
+			if (si < 0 || m_subsets[si].numVolumes > 0) {
+				continue;
+			}
+			SubsetStatistics& stats = partial[si];
+			stats.boundaryArea += FaceArea(f, aaPos);
+			number size = ElementSize(f, aaPos);
+			stats.minElementSize = std::min(stats.minElementSize, size);
+			stats.maxElementSize = std::max(stats.maxElementSize, size);
+		}
+
+		/// edges count for subsets without volumes and faces only
+		#ifdef _OPENMP
+		#pragma omp for schedule(static) nowait
+		#endif
+		for (int i = 0; i < numEdges; i++) {
+			Edge* e = edges[i];
+			const int si = sh.get_subset_index(e);
+			if (si < 0 || m_subsets[si].numVolumes > 0 || m_subsets[si].numFaces > 0) {
+				continue;
+			}
+			number size = ElementSize(e, aaPos);
+			partial[si].minElementSize = std::min(partial[si].minElementSize, size);
+			partial[si].maxElementSize = std::max(partial[si].maxElementSize, size);
+		}
+
+		#ifdef _OPENMP
+		#pragma omp critical
+		#endif
+		{
+			for (int si = 0; si < numSubsets; si++) {
+				SubsetStatistics& stats = m_subsets[si];
+				stats.volume += partial[si].volume;
+				stats.boundaryArea += partial[si].boundaryArea;
+				stats.minElementSize = std::min(stats.minElementSize, partial[si].minElementSize);
+				stats.maxElementSize = std::max(stats.maxElementSize, partial[si].maxElementSize);
+			}
+		}
+	}
+
+	/// subsets without measured elements
+	for (int si = 0; si < numSubsets; si++) {
+		if (m_subsets[si].minElementSize == std::numeric_limits<number>::max()) {
+			m_subsets[si].minElementSize = 0;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////
+/// SUBSET
+/////////////////////////////////////////////////////////
+const MeshStatistics::SubsetStatistics& MeshStatistics::subset(size_t si) const {
+	UG_COND_THROW(si >= m_subsets.size(), "Subset index " << si << " out of range, "
+			"mesh has " << m_subsets.size() << " subsets.");
+	return m_subsets[si];
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_SUBSETS
+/////////////////////////////////////////////////////////
+size_t MeshStatistics::num_subsets() const {
+	return m_subsets.size();
+}
+
+/////////////////////////////////////////////////////////
+/// SUBSET_NAME
+/////////////////////////////////////////////////////////
+std::string MeshStatistics::subset_name(size_t si) const {
+	return subset(si).name;
+}
+
+/////////////////////////////////////////////////////////
+/// SUBSET_INDEX
+/////////////////////////////////////////////////////////
+int MeshStatistics::subset_index(const std::string& name) const {
+	for (size_t si = 0; si < m_subsets.size(); si++) {
+		if (m_subsets[si].name == name) {
+			return static_cast<int>(si);
+		}
+	}
+	return -1;
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_VERTICES
+/////////////////////////////////////////////////////////
+size_t MeshStatistics::num_vertices(size_t si) const {
+	return subset(si).numVertices;
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_EDGES
+/////////////////////////////////////////////////////////
+size_t MeshStatistics::num_edges(size_t si) const {
+	return subset(si).numEdges;
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_FACES
+/////////////////////////////////////////////////////////
+size_t MeshStatistics::num_faces(size_t si) const {
+	return subset(si).numFaces;
+}
+
+/////////////////////////////////////////////////////////
+/// NUM_VOLUMES
+/////////////////////////////////////////////////////////
+size_t MeshStatistics::num_volumes(size_t si) const {
+	return subset(si).numVolumes;
+}
+
+/////////////////////////////////////////////////////////
+/// VOLUME
+/////////////////////////////////////////////////////////
+ug::number MeshStatistics::volume(size_t si) const {
+	return subset(si).volume;
+}
+
+/////////////////////////////////////////////////////////
+/// BOUNDARY_AREA
+/////////////////////////////////////////////////////////
+ug::number MeshStatistics::boundary_area(size_t si) const {
+	return subset(si).boundaryArea;
+}
+
+/////////////////////////////////////////////////////////
+/// MIN_ELEMENT_SIZE
+/////////////////////////////////////////////////////////
+ug::number MeshStatistics::min_element_size(size_t si) const {
+	return subset(si).minElementSize;
+}
+
+/////////////////////////////////////////////////////////
+/// MAX_ELEMENT_SIZE
+/////////////////////////////////////////////////////////
+ug::number MeshStatistics::max_element_size(size_t si) const {
+	return subset(si).maxElementSize;
+}
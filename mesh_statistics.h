@@ -0,0 +1,139 @@
+/*!
+ * \file plugins/skin_layer_generator/mesh_statistics.h
+ * \brief Per-subset statistics of a generated mesh
+ *
+ *  Created on: October 19, 2026
+ *      Author: agent
+ */
+#ifndef __H__UG__SKIN_LAYER_GENERATOR__MESH_STATISTICS__
+#define __H__UG__SKIN_LAYER_GENERATOR__MESH_STATISTICS__
+
+#include <vector>
+#include <string>
+#include "lib_grid/lib_grid.h"
+
+namespace ug {
+	namespace skin_layer_generator {
+		/*!
+		 * \brief MeshStatistics
+		 *
+		 * Element counts, volume, boundary area and element sizes of each
+		 * subset of a grid. All subsets are evaluated in one pass over the
+		 * grid's volumes and faces with per-thread accumulators, which runs
+		 * in parallel if built with OpenMP.
+		 */
+		class MeshStatistics {
+		public:
+			/*!
+			 * \brief compute the statistics of the given grid
+			 *
+			 * \param[in] grid
+			 * \param[in] sh subset handler
+			 */
+			MeshStatistics(Grid& grid, SubsetHandler& sh);
+
+			/*!
+			 * \brief number of subsets
+			 */
+			size_t num_subsets() const;
+
+			/*!
+			 * \brief name of a subset
+			 * \param[in] si subset index
+			 */
+			std::string subset_name(size_t si) const;
+
+			/*!
+			 * \brief index of a subset by name, -1 if not found
+			 * \param[in] name subset's name
+			 */
+			int subset_index(const std::string& name) const;
+
+			/*!
+			 * \brief number of vertices in a subset
+			 * \param[in] si subset index
+			 */
+			size_t num_vertices(size_t si) const;
+
+			/*!
+			 * \brief number of edges in a subset
+			 * \param[in] si subset index
+			 */
+			size_t num_edges(size_t si) const;
+
+			/*!
+			 * \brief number of faces in a subset
+			 * \param[in] si subset index
+			 */
+			size_t num_faces(size_t si) const;
+
+			/*!
+			 * \brief number of volumes in a subset
+			 * \param[in] si subset index
+			 */
+			size_t num_volumes(size_t si) const;
+
+			/*!
+			 * \brief total volume of a subset's volume elements
+			 * \param[in] si subset index
+			 */
+			number volume(size_t si) const;
+
+			/*!
+			 * \brief area of a subset's boundary
+			 *
+			 * Area of the faces adjacent to exactly one of the subset's volumes.
+			 * For subsets without volumes the area of the faces.
+			 *
+			 * \param[in] si subset index
+			 */
+			number boundary_area(size_t si) const;
+
+			/*!
+			 * \brief minimal element size (largest vertex distance) of a subset
+			 *
+			 * Measured on the highest dimensional elements of the subset.
+			 *
+			 * \param[in] si subset index
+			 */
+			number min_element_size(size_t si) const;
+
+			/*!
+			 * \brief maximal element size (largest vertex distance) of a subset
+			 * \param[in] si subset index
+			 */
+			number max_element_size(size_t si) const;
+
+		private:
+			/*!
+			 * \brief encapsulates the statistics of one subset
+			 */
+			struct SubsetStatistics {
+				std::string name;
+				size_t numVertices;
+				size_t numEdges;
+				size_t numFaces;
+				size_t numVolumes;
+				number volume;
+				number boundaryArea;
+				number minElementSize;
+				number maxElementSize;
+
+				/*!
+				 * \brief construct empty statistics
+				 */
+				SubsetStatistics() : numVertices(0), numEdges(0), numFaces(0),
+									 numVolumes(0), volume(0), boundaryArea(0),
+									 minElementSize(0), maxElementSize(0) {
+				}
+			};
+
+			/// access a subset's statistics with range check
+			const SubsetStatistics& subset(size_t si) const;
+
+			std::vector<SubsetStatistics> m_subsets;
+		};
+	}
+}
+
+#endif // __H__UG__SKIN_LAYER_GENERATOR__MESH_STATISTICS__
@@ -34,6 +34,21 @@ namespace ug {
 
 				// typedefs
 				typedef skin_layer_generator::SkinLayerGenerator TSLG;
+				typedef skin_layer_generator::MeshStatistics TMS;
+
+				/// registry of MeshStatistics
+				reg.add_class_<TMS>("SkinLayerMeshStatistics", grp)
+						.add_method("num_subsets", &TMS::num_subsets, "number of subsets", "", "number of subsets", "")
+						.add_method("subset_name", &TMS::subset_name, "subset's name", "subset index", "name of subset", "")
+						.add_method("subset_index", &TMS::subset_index, "subset index", "subset's name", "index of subset, -1 if not found", "")
+						.add_method("num_vertices", &TMS::num_vertices, "number of vertices", "subset index", "number of vertices in subset", "")
+						.add_method("num_edges", &TMS::num_edges, "number of edges", "subset index", "number of edges in subset", "")
+						.add_method("num_faces", &TMS::num_faces, "number of faces", "subset index", "number of faces in subset", "")
+						.add_method("num_volumes", &TMS::num_volumes, "number of volumes", "subset index", "number of volumes in subset", "")
+						.add_method("volume", &TMS::volume, "volume", "subset index", "total volume of subset", "")
+						.add_method("boundary_area", &TMS::boundary_area, "area", "subset index", "boundary area of subset", "")
+						.add_method("min_element_size", &TMS::min_element_size, "size", "subset index", "minimal element size in subset", "")
+						.add_method("max_element_size", &TMS::max_element_size, "size", "subset index", "maximal element size in subset", "");
 
 				/// registry of SkinLayerGenerator
 				reg.add_class_<TSLG>("SkinLayerGenerator", grp)
@@ -41,7 +56,11 @@ namespace ug {
 						.add_method("generate", (void (TSLG::*)())(&TSLG::generate), "", "", "generate the mesh", "")
 						.add_method("add_layer", (void (TSLG::*)(number, number, const std::string&))(&TSLG::add_layer), "", "layer's name#layer's thickness#layer's resolution", "add skin layer", "")
 						.add_method("add_layer_with_injection", (void (TSLG::*)(number, number, const std::string&, const std::string&, number, number, number))(&TSLG::add_layer_with_injection), "", "layer's name#layer's thickness#layer's resolution#injection's name#injection's thickness#injection's resolution#injection's relative position in layer", "add skin layer with injection", "")
-						.add_method("enable_output_straightening", (void (TSLG::*)(bool))(&TSLG::set_straighten_subset_names_for_lua), "", "true or false", "");
+						.add_method("enable_output_straightening", (void (TSLG::*)(bool))(&TSLG::set_straighten_subset_names_for_lua), "", "true or false", "")
+						.add_method("enable_mesh_optimization", (void (TSLG::*)(bool))(&TSLG::set_optimize_mesh), "", "true or false", "smooth and flip tetrahedral mesh after tetrahedralization (multi-threaded only if built with SLGOpenMP=ON)", "")
+						.add_method("set_num_optimization_steps", (void (TSLG::*)(size_t))(&TSLG::set_num_optimization_steps), "", "number of smoothing and flip sweeps", "", "")
+						.add_method("enable_preview", (void (TSLG::*)(bool))(&TSLG::set_preview), "", "true or false", "low-resolution surface mesh only", "")
+						.add_method("statistics", &TSLG::statistics, "mesh statistics", "", "per-subset statistics of generated mesh", "");
 			}
 		};
 	}
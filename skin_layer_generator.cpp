@@ -10,6 +10,7 @@
  *      Author: Stephan Grein
  */
 #include "skin_layer_generator.h"
+#include "mesh_optimizer.h"
 #include "lib_grid/lib_grid.h"
 #include "lib_grid/algorithms/remove_duplicates_util.h"
 #include "bridge/domain_bridges/selection_bridge.h"
@@ -73,13 +74,22 @@ void SkinLayerGenerator::generate() {
 	/// init promesh
 	using namespace promesh;
 	Mesh* mesh = new Mesh();
+	m_spStatistics = SPNULL;
+
+	/// ring resolution (capped in preview mode)
+	size_t numVerticesInjection = m_numVerticesInjection;
+	size_t numVertices = m_numVertices;
+	if (m_bPreview) {
+		numVerticesInjection = std::min(numVerticesInjection, PREVIEW_NUM_VERTICES);
+		numVertices = std::min(numVertices, PREVIEW_NUM_VERTICES);
+	}
 
 	/// mesh operations: check for minimal consistency first
 	UG_COND_THROW(m_radiusInjection == 0, "Radius of injection layer has to be > 0.")
-	CreateCircle(mesh, m_centerInjection, m_radiusInjection, m_numVerticesInjection, 0, false);
+	CreateCircle(mesh, m_centerInjection, m_radiusInjection, numVerticesInjection, 0, false);
 
 	UG_COND_THROW(m_radius == 0, "Radius of skin layer has to be > 0.")
-	CreateCircle(mesh, m_center, m_radius, m_numVertices, 1, false);
+	CreateCircle(mesh, m_center, m_radius, numVertices, 1, false);
 
 	UG_COND_THROW(number_of_injections() > 1, "Currently only _one_ injection supported.");
 
@@ -93,38 +103,47 @@ void SkinLayerGenerator::generate() {
 	/// Step I: GENERATE DELAUNAY MESH
     /////////////////////////////////////////////////////////
 	UG_DLOG(SLGGenerateMesh, 0, "Step I: GENERATE DELAUNAY MESH");
-	number totalHeight = 0;
 	mesh->selector().clear();
 	SelectSubset(mesh, 0, true, true, true, true);
 	SelectSubset(mesh, 1, true, true, true, true);
+	/// rims of bottom and top are neither filled nor refined before Step IV,
+	/// thus their edges stay valid: bottom rim are the initial circles
+	std::vector<Edge*> bottomRim(mesh->selector().edges_begin(), mesh->selector().edges_end());
 	for (std::vector<Layer>::const_iterator it = m_layers.begin(); it != m_layers.end(); ++it) {
+		/// the top is not filled here but from its rim in Step IV
+		bool isTop = (it + 1 == m_layers.end());
 		if (it->has_injection()) {
 			SmartPtr<Injection> inj = it->get_injection();
 			number diff = it->thickness - inj->thickness - it->thickness*inj->position;
-			ExtrudeAndMove(mesh, ug::vector3(0, 0, it->thickness*inj->position), (it->thickness*inj->position) / it->resolution, true, false);
+			ExtrudeAndMove(mesh, ug::vector3(0, 0, it->thickness*inj->position), extrusion_steps(it->thickness*inj->position, it->resolution), true, false);
 			FixFaceOrientation(mesh->grid(), mesh->selector().begin<Face>(), mesh->selector().end<Face>());
 			TriangleFill_SweepLine(mesh->grid(), mesh->selector().edges_begin(), mesh->selector().edges_end(), aPosition, aInt, &mesh->subset_handler());
 
-			ExtrudeAndMove(mesh, ug::vector3(0, 0, inj->thickness), (inj->thickness) / inj->resolution, true, false);
+			ExtrudeAndMove(mesh, ug::vector3(0, 0, inj->thickness), extrusion_steps(inj->thickness, inj->resolution), true, false);
 			FixFaceOrientation(mesh->grid(), mesh->selector().begin<Face>(), mesh->selector().end<Face>());
 			TriangleFill_SweepLine(mesh->grid(), mesh->selector().edges_begin(), mesh->selector().edges_end(), aPosition, aInt, &mesh->subset_handler());
 
-			ExtrudeAndMove(mesh, ug::vector3(0, 0, diff), diff / it->resolution, true, false);
+			ExtrudeAndMove(mesh, ug::vector3(0, 0, diff), extrusion_steps(diff, it->resolution), true, false);
 			FixFaceOrientation(mesh->grid(), mesh->selector().begin<Face>(), mesh->selector().end<Face>());
-			totalHeight += it->thickness;
-
-			TriangleFill_SweepLine(mesh->grid(), mesh->selector().edges_begin(), mesh->selector().edges_end(), aPosition, aInt, &mesh->subset_handler());
+			if (!isTop) {
+				TriangleFill_SweepLine(mesh->grid(), mesh->selector().edges_begin(), mesh->selector().edges_end(), aPosition, aInt, &mesh->subset_handler());
+			}
 		}
 		else {
-			ExtrudeAndMove(mesh, ug::vector3(0, 0, it->thickness), it->thickness / it->resolution, true, false);
-			totalHeight += it->thickness;
-			ug::promesh::TriangleFill(mesh, true, m_degTri, 1);
+			ExtrudeAndMove(mesh, ug::vector3(0, 0, it->thickness), extrusion_steps(it->thickness, it->resolution), true, false);
+			if (!isTop) {
+				ug::promesh::TriangleFill(mesh, !m_bPreview, m_degTri, 1);
+			}
 		}
 		FixFaceOrientation(mesh->grid(), mesh->selector().begin<Face>(), mesh->selector().end<Face>());
 	}
+	/// rim of the top, i.e. the edges of the last extrusion (left unfilled)
+	std::vector<Edge*> topRim(mesh->selector().edges_begin(), mesh->selector().edges_end());
 	AssignSelectionToSubset(mesh->selector(), mesh->subset_handler(), 1);
 	AssignSubsetColors(mesh->subset_handler());
-	SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step0.ugx");
+	if (!m_bPreview) {
+		SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step0.ugx");
+	}
 
     /////////////////////////////////////////////////////////
 	/// Step II: ASSIGN DELAUNAY MESH TO SUBSETS
@@ -206,7 +225,9 @@ void SkinLayerGenerator::generate() {
 
 	EraseEmptySubsets(mesh->subset_handler());
 	AssignSubsetColors(mesh->subset_handler());
-	SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step1.ugx");
+	if (!m_bPreview) {
+		SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step1.ugx");
+	}
 	mesh->selector().clear();
 
     /////////////////////////////////////////////////////////
@@ -223,7 +244,9 @@ void SkinLayerGenerator::generate() {
 		si++;
 	}
 	mesh->subset_handler().subset_info(si).name = "Surface";
-	SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step2.ugx");
+	if (!m_bPreview) {
+		SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step2.ugx");
+	}
 
 
     /////////////////////////////////////////////////////////
@@ -232,28 +255,43 @@ void SkinLayerGenerator::generate() {
 	/// BOTTOM
 	UG_DLOG(SLGGenerateMesh, 0, "Step IV: TRIANGULATE TOP AND BOTTOM SURFACES");
 	mesh->selector().clear();
-	SelectElementsInCylinder<ug::Edge>(mesh, ug::vector3(0, 0, -SELECTION_THRESHOLD), ug::vector3(0, 0, SELECTION_THRESHOLD), m_radius);
+	mesh->selector().select(bottomRim.begin(), bottomRim.end());
 	CloseSelection(mesh);
-	TriangleFill_SweepLine(mesh->grid(), mesh->selector().edges_begin(), mesh->selector().edges_end(), aPosition, aInt, &mesh->subset_handler());
-	SelectSubset(mesh, -1, true, true, true, true);
-	Retriangulate(mesh, m_degTri);
-	SelectSubset(mesh, -1, true, true, true, true);
+	/// elements created for the cap are selected as they are created, thus
+	/// the cap is collected without scanning the grid for unassigned elements
+	/// (the fill iterates the rim itself, not the growing selection)
+	mesh->selector().enable_autoselection(true);
+	TriangleFill_SweepLine(mesh->grid(), bottomRim.begin(), bottomRim.end(), aPosition, aInt, &mesh->subset_handler());
+	if (!m_bPreview) {
+		Retriangulate(mesh, m_degTri);
+	}
+	mesh->selector().enable_autoselection(false);
 	AssignSubset(mesh, si);
 	mesh->selector().clear();
 	mesh->subset_handler().subset_info(si).name = "Bottom Surface";
 
 	/// TOP
-	SelectElementsInCylinder<ug::Edge>(mesh, ug::vector3(0, 0, totalHeight-SELECTION_THRESHOLD), ug::vector3(0, 0, totalHeight +SELECTION_THRESHOLD), m_radius);
+	mesh->selector().select(topRim.begin(), topRim.end());
 	CloseSelection(mesh);
-	TriangleFill_SweepLine(mesh->grid(), mesh->selector().edges_begin(), mesh->selector().edges_end(), aPosition, aInt, &mesh->subset_handler());
-	SelectSubset(mesh, -1, true, true, true, true);
-	Retriangulate(mesh, m_degTri);
-	SelectSubset(mesh, -1, true, true, true, true);
+	mesh->selector().enable_autoselection(true);
+	TriangleFill_SweepLine(mesh->grid(), topRim.begin(), topRim.end(), aPosition, aInt, &mesh->subset_handler());
+	if (!m_bPreview) {
+		Retriangulate(mesh, m_degTri);
+	}
+	mesh->selector().enable_autoselection(false);
 	si++;
 	AssignSubset(mesh, si);
 	mesh->subset_handler().subset_info(si).name = "Top Surface";
 	EraseEmptySubsets(mesh->subset_handler());
 	AssignSubsetColors(mesh);
+
+	/// preview mode: labeled surface mesh only, skip tetrahedralization
+	if (m_bPreview) {
+		SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_preview.ugx");
+		m_spStatistics = make_sp(new MeshStatistics(mesh->grid(), mesh->subset_handler()));
+		delete mesh;
+		return;
+	}
 	SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step3.ugx");
 
     /////////////////////////////////////////////////////////
@@ -267,6 +305,16 @@ void SkinLayerGenerator::generate() {
 	AssignSubsetColors(mesh->subset_handler());
 	SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step4.ugx");
 
+    /////////////////////////////////////////////////////////
+	/// Step V b): OPTIMIZE THE TETRAHEDRAL MESH (optional)
+    /////////////////////////////////////////////////////////
+	if (m_bOptimizeMesh) {
+		UG_DLOG(SLGGenerateMesh, 0, "Step V b): OPTIMIZE THE TETRAHEDRAL MESH");
+		TetMeshOptimizer optimizer(mesh->grid(), mesh->subset_handler());
+		optimizer.optimize(m_numOptimizationSteps);
+		SaveGridToFile(mesh->grid(), mesh->subset_handler(), "skin_layer_generator_step4b.ugx");
+	}
+
     /////////////////////////////////////////////////////////
 	/// Step VI: ASSIGN GENERATED VOLUMINA
     /////////////////////////////////////////////////////////
@@ -435,7 +483,8 @@ void SkinLayerGenerator::generate() {
 		}
 	}
 
-	/// delete mesh
+	/// statistics of final grid and delete mesh
+	m_spStatistics = make_sp(new MeshStatistics(mesh->grid(), mesh->subset_handler()));
 	delete mesh;
 }
 
@@ -454,7 +503,69 @@ bool SkinLayerGenerator::is_straighten_subset_names_for_lua() const {
 }
 
 
+/////////////////////////////////////////////////////////
+/// SET_OPTIMIZE_MESH
+/////////////////////////////////////////////////////////
+void SkinLayerGenerator::set_optimize_mesh(bool optimize) {
+	m_bOptimizeMesh = optimize;
+}
+
+/////////////////////////////////////////////////////////
+/// IS_OPTIMIZE_MESH
+/////////////////////////////////////////////////////////
+bool SkinLayerGenerator::is_optimize_mesh() const {
+	return m_bOptimizeMesh;
+}
+
+/////////////////////////////////////////////////////////
+/// SET_NUM_OPTIMIZATION_STEPS
+/////////////////////////////////////////////////////////
+void SkinLayerGenerator::set_num_optimization_steps(size_t numSteps) {
+	m_numOptimizationSteps = numSteps;
+}
+
+/////////////////////////////////////////////////////////
+/// SET_PREVIEW
+/////////////////////////////////////////////////////////
+void SkinLayerGenerator::set_preview(bool preview) {
+	m_bPreview = preview;
+}
+
+/////////////////////////////////////////////////////////
+/// IS_PREVIEW
+/////////////////////////////////////////////////////////
+bool SkinLayerGenerator::is_preview() const {
+	return m_bPreview;
+}
+
+/////////////////////////////////////////////////////////
+/// EXTRUSION_STEPS
+/////////////////////////////////////////////////////////
+size_t SkinLayerGenerator::extrusion_steps(number height, number resolution) const {
+	/// flush or overlapping layers are not extruded
+	if (height <= 0) {
+		return 0;
+	}
+
+	size_t steps = static_cast<size_t>(height / resolution);
+	if (m_bPreview) {
+		steps = std::max<size_t>(1, std::min(steps, PREVIEW_MAX_EXTRUSION_STEPS));
+	}
+	return steps;
+}
+
+/////////////////////////////////////////////////////////
+/// STATISTICS
+/////////////////////////////////////////////////////////
+SmartPtr<MeshStatistics> SkinLayerGenerator::statistics() const {
+	UG_COND_THROW(m_spStatistics.invalid(), "No statistics available, generate the mesh first.");
+	return m_spStatistics;
+}
+
+
 /////////////////////////////////////////////////////////
 /// constants
 /////////////////////////////////////////////////////////
 const number SkinLayerGenerator::SELECTION_THRESHOLD = 0.1;
+const size_t SkinLayerGenerator::PREVIEW_NUM_VERTICES = 4;
+const size_t SkinLayerGenerator::PREVIEW_MAX_EXTRUSION_STEPS = 1;
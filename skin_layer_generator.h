@@ -13,6 +13,7 @@
 #include <algorithm>
 #include "lib_grid/lib_grid.h"
 #include <boost/assign/list_of.hpp>
+#include "mesh_statistics.h"
 
 namespace ug {
 	namespace skin_layer_generator {
@@ -29,7 +30,9 @@ namespace ug {
 								   m_radius(1), m_radiusInjection(0.5),
 								   m_numVertices(10), m_numVerticesInjection(10),
 								   m_degTri(30), m_degTet(18),
-								   m_bStraightenSubsetNamesForLua(false) {
+								   m_bStraightenSubsetNamesForLua(false),
+								   m_bOptimizeMesh(false), m_numOptimizationSteps(5),
+								   m_bPreview(false) {
 			}
 
            	/*!
@@ -80,8 +83,61 @@ namespace ug {
 			 */
 			bool is_straighten_subset_names_for_lua() const;
 
+			/*!
+			 * \brief enables smoothing and flipping of the tetrahedral mesh after Step V
+			 *
+			 * The vertex updates only run in parallel if the plugin is built
+			 * with SLGOpenMP=ON, otherwise they run serially. Flips are always
+			 * done serially.
+			 *
+			 * \param[in] optimize
+			 */
+			void set_optimize_mesh(bool optimize);
+
+			/*!
+			 * \brief check if smoothing and flipping of the tetrahedral mesh enabled
+			 */
+			bool is_optimize_mesh() const;
+
+			/*!
+			 * \brief sets the number of smoothing and flip sweeps
+			 * \param[in] numSteps
+			 */
+			void set_num_optimization_steps(size_t numSteps);
+
+			/*!
+			 * \brief enables the low-resolution preview mode
+			 *
+			 * Caps ring vertices and extrusion steps, skips tetrahedralization
+			 * and only writes the labeled surface mesh.
+			 *
+			 * \param[in] preview
+			 */
+			void set_preview(bool preview);
+
+			/*!
+			 * \brief check if preview mode enabled
+			 */
+			bool is_preview() const;
+
+			/*!
+			 * \brief per-subset statistics of the last generated mesh
+			 */
+			SmartPtr<MeshStatistics> statistics() const;
+
 
 		private:
+			/*!
+			 * \brief number of extrusion steps for a given height
+			 *
+			 * No steps for heights <= 0, at least one step for positive
+			 * heights in preview mode.
+			 *
+			 * \param[in] height height to extrude
+			 * \param[in] resolution layer's resolution
+			 */
+			size_t extrusion_steps(number height, number resolution) const;
+
 			/// grid generation parameters
 			ug::vector3 m_center;
 			ug::vector3 m_centerInjection;
@@ -190,9 +246,21 @@ namespace ug {
 
 			/// grid generation constants
 			static const number SELECTION_THRESHOLD;
+			static const size_t PREVIEW_NUM_VERTICES;
+			static const size_t PREVIEW_MAX_EXTRUSION_STEPS;
 
 			/// output parameters
 			bool m_bStraightenSubsetNamesForLua;
+
+			/// optimization parameters
+			bool m_bOptimizeMesh;
+			size_t m_numOptimizationSteps;
+
+			/// preview parameters
+			bool m_bPreview;
+
+			/// statistics of the last generated mesh
+			SmartPtr<MeshStatistics> m_spStatistics;
 		};
 	}
 }
@@ -9,11 +9,110 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include <boost/test/parameterized_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <vector>
 #include "../../skin_layer_generator.h"
+#include "../../mesh_optimizer.h"
+#include "../../mesh_statistics.h"
 
 using namespace boost::unit_test;
 using namespace ug::skin_layer_generator;
 
+namespace {
+	/// total height of the test stack
+	const ug::number TEST_STACK_HEIGHT = 4;
+
+	/*!
+	 * \brief adds a stack with a depot in the middle and a plain layer on top
+	 *
+	 * \param[in,out] slg
+	 */
+	void AddTestStack(SkinLayerGenerator& slg) {
+		slg.add_layer("Epidermis", 1, 0.5);
+		slg.add_layer_with_injection("Dermis", 2, 0.5, "Depot", 0.5, 0.25, 0.25);
+		slg.add_layer("Hypodermis", 1, 0.5);
+	}
+
+	/*!
+	 * \brief total area of the faces lying in the plane z = height
+	 *
+	 * \param[in] grid
+	 * \param[in] height
+	 */
+	ug::number AreaAtHeight(ug::Grid& grid, ug::number height) {
+		ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+		ug::number area = 0;
+		for (ug::FaceIterator fIter = grid.faces_begin(); fIter != grid.faces_end(); ++fIter) {
+			ug::Face* f = *fIter;
+			bool inPlane = true;
+			for (size_t i = 0; i < f->num_vertices(); i++) {
+				inPlane = inPlane && std::fabs(aaPos[f->vertex(i)].z() - height) < 1e-8;
+			}
+			if (inPlane) {
+				area += ug::FaceArea(f, aaPos);
+			}
+		}
+		return area;
+	}
+
+	/*!
+	 * \brief minimal quality of all tetrahedra of a grid
+	 *
+	 * \param[in] grid
+	 */
+	ug::number MinTetrahedronQuality(ug::Grid& grid) {
+		ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+		ug::number quality = 1;
+		for (ug::VolumeIterator vIter = grid.volumes_begin(); vIter != grid.volumes_end(); ++vIter) {
+			ug::Volume* vol = *vIter;
+			quality = std::min(quality, std::fabs(TetrahedronQuality(aaPos[vol->vertex(0)],
+					aaPos[vol->vertex(1)], aaPos[vol->vertex(2)], aaPos[vol->vertex(3)])));
+		}
+		return quality;
+	}
+
+	/*!
+	 * \brief creates the corners of the octahedron |x|+|y|+|z| = 1
+	 *
+	 * Corners are ordered +x, -x, +y, -y, +z, -z.
+	 *
+	 * \param[in,out] grid
+	 * \param[out] corners
+	 */
+	void CreateOctahedronCorners(ug::Grid& grid, ug::Vertex* corners[6]) {
+		ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+		for (size_t i = 0; i < 6; i++) {
+			corners[i] = *grid.create<ug::RegularVertex>();
+			ug::vector3 pos(0, 0, 0);
+			pos[i / 2] = i % 2 ? -1 : 1;
+			aaPos[corners[i]] = pos;
+		}
+	}
+
+	/*!
+	 * \brief creates a triangle on the unit circle and two apexes above and below
+	 *
+	 * Vertices are ordered: three triangle corners, apex at +height, apex at -height.
+	 *
+	 * \param[in,out] grid
+	 * \param[in] height
+	 * \param[out] vrts
+	 */
+	void CreateBipyramidCorners(ug::Grid& grid, ug::number height, ug::Vertex* vrts[5]) {
+		ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+		for (size_t i = 0; i < 5; i++) {
+			vrts[i] = *grid.create<ug::RegularVertex>();
+		}
+		for (size_t i = 0; i < 3; i++) {
+			aaPos[vrts[i]] = ug::vector3(std::cos(2 * M_PI * i / 3), std::sin(2 * M_PI * i / 3), 0);
+		}
+		aaPos[vrts[3]] = ug::vector3(0, 0, height);
+		aaPos[vrts[4]] = ug::vector3(0, 0, -height);
+	}
+}
+
 /////////////////////////////////////////////////////////
 /// TESTSUITE SKIN_LAYER_GENERATOR
 /////////////////////////////////////////////////////////
@@ -23,4 +122,310 @@ BOOST_AUTO_TEST_SUITE(SKIN_LAYER_GENERATOR)
 BOOST_AUTO_TEST_CASE(DUMMY_TEST) {
 }
 
+/// quality of regular, inverted and degenerated tetrahedra
+BOOST_AUTO_TEST_CASE(TETRAHEDRON_QUALITY) {
+	ug::vector3 p0(1, 1, 1), p1(1, -1, -1), p2(-1, 1, -1), p3(-1, -1, 1);
+	BOOST_CHECK_CLOSE(std::fabs(TetrahedronQuality(p0, p1, p2, p3)), 1.0, 1e-8);
+	BOOST_CHECK_CLOSE(TetrahedronQuality(p0, p1, p2, p3), -TetrahedronQuality(p1, p0, p2, p3), 1e-8);
+	BOOST_CHECK_SMALL(TetrahedronQuality(p0, p1, p2, p2), 1e-12);
+}
+
+/// statistics of a single unit tetrahedron
+BOOST_AUTO_TEST_CASE(MESH_STATISTICS) {
+	ug::Grid grid(ug::GRIDOPT_STANDARD_INTERCONNECTION | ug::GRIDOPT_AUTOGENERATE_SIDES);
+	grid.attach_to_vertices(ug::aPosition);
+	ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+	ug::Vertex* v[4];
+	for (size_t i = 0; i < 4; i++) {
+		v[i] = *grid.create<ug::RegularVertex>();
+		aaPos[v[i]] = ug::vector3(i == 1, i == 2, i == 3);
+	}
+	ug::Volume* tet = *grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(v[0], v[1], v[2], v[3]));
+	ug::SubsetHandler sh(grid);
+	sh.assign_subset(tet, 0);
+
+	MeshStatistics stats(grid, sh);
+	BOOST_REQUIRE_EQUAL(stats.num_subsets(), 1u);
+	BOOST_CHECK_EQUAL(stats.num_volumes(0), 1u);
+	BOOST_CHECK_CLOSE(stats.volume(0), 1.0 / 6, 1e-8);
+	BOOST_CHECK_CLOSE(stats.boundary_area(0), 1.5 + std::sqrt(3.0) / 2, 1e-8);
+	BOOST_CHECK_CLOSE(stats.min_element_size(0), std::sqrt(2.0), 1e-8);
+	BOOST_CHECK_CLOSE(stats.max_element_size(0), std::sqrt(2.0), 1e-8);
+}
+
+/// shared faces bound a subset only if shared with another subset, face-only subsets
+BOOST_AUTO_TEST_CASE(MESH_STATISTICS_SHARED_FACES) {
+	for (size_t separate = 0; separate < 2; separate++) {
+		ug::Grid grid(ug::GRIDOPT_STANDARD_INTERCONNECTION | ug::GRIDOPT_AUTOGENERATE_SIDES);
+		grid.attach_to_vertices(ug::aPosition);
+		ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+		ug::SubsetHandler sh(grid);
+
+		/// unit tetrahedron and a larger one sharing its slanted face
+		ug::Vertex* v[5];
+		for (size_t i = 0; i < 5; i++) {
+			v[i] = *grid.create<ug::RegularVertex>();
+			aaPos[v[i]] = i < 4 ? ug::vector3(i == 1, i == 2, i == 3) : ug::vector3(2, 2, 2);
+		}
+		ug::Volume* smallTet = *grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(v[0], v[1], v[2], v[3]));
+		ug::Volume* largeTet = *grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(v[1], v[2], v[3], v[4]));
+		sh.assign_subset(smallTet, 0);
+		sh.assign_subset(largeTet, separate ? 1 : 0);
+
+		/// two loose triangles in a face-only subset
+		const int faceSubset = separate ? 2 : 1;
+		for (size_t i = 0; i < 2; i++) {
+			ug::number z = 5 + i, size = 1 + i;
+			ug::Vertex* t[3];
+			for (size_t j = 0; j < 3; j++) {
+				t[j] = *grid.create<ug::RegularVertex>();
+				aaPos[t[j]] = ug::vector3(size * (j == 1), size * (j == 2), z);
+			}
+			sh.assign_subset(*grid.create<ug::Triangle>(ug::TriangleDescriptor(t[0], t[1], t[2])), faceSubset);
+		}
+
+		MeshStatistics stats(grid, sh);
+		BOOST_REQUIRE_EQUAL(stats.num_subsets(), separate ? 3u : 2u);
+		const ug::number sharedArea = std::sqrt(3.0) / 2;
+		const ug::number smallArea = 1.5, largeArea = 1.5 * std::sqrt(17.0);
+		if (separate) {
+			/// the shared face bounds both subsets
+			BOOST_CHECK_CLOSE(stats.volume(0), 1.0 / 6, 1e-8);
+			BOOST_CHECK_CLOSE(stats.volume(1), 5.0 / 6, 1e-8);
+			BOOST_CHECK_CLOSE(stats.boundary_area(0), smallArea + sharedArea, 1e-8);
+			BOOST_CHECK_CLOSE(stats.boundary_area(1), largeArea + sharedArea, 1e-8);
+			BOOST_CHECK_CLOSE(stats.min_element_size(1), 3.0, 1e-8);
+		} else {
+			/// the shared face is inside the subset
+			BOOST_CHECK_EQUAL(stats.num_volumes(0), 2u);
+			BOOST_CHECK_CLOSE(stats.volume(0), 1.0, 1e-8);
+			BOOST_CHECK_CLOSE(stats.boundary_area(0), smallArea + largeArea, 1e-8);
+			BOOST_CHECK_CLOSE(stats.min_element_size(0), std::sqrt(2.0), 1e-8);
+			BOOST_CHECK_CLOSE(stats.max_element_size(0), 3.0, 1e-8);
+		}
+
+		/// face-only subset: area and size of its faces
+		BOOST_CHECK_EQUAL(stats.num_faces(faceSubset), 2u);
+		BOOST_CHECK_EQUAL(stats.num_volumes(faceSubset), 0u);
+		BOOST_CHECK_CLOSE(stats.boundary_area(faceSubset), 2.5, 1e-8);
+		BOOST_CHECK_CLOSE(stats.min_element_size(faceSubset), std::sqrt(2.0), 1e-8);
+		BOOST_CHECK_CLOSE(stats.max_element_size(faceSubset), 2 * std::sqrt(2.0), 1e-8);
+	}
+}
+
+/// an off-center inner vertex is moved back, constrained vertices stay
+BOOST_AUTO_TEST_CASE(TET_MESH_OPTIMIZER) {
+	ug::Grid grid(ug::GRIDOPT_STANDARD_INTERCONNECTION | ug::GRIDOPT_AUTOGENERATE_SIDES);
+	grid.attach_to_vertices(ug::aPosition);
+	ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+	ug::SubsetHandler sh(grid);
+
+	/// octahedron split into eight tetrahedra at an off-center inner vertex
+	ug::Vertex* corners[6];
+	CreateOctahedronCorners(grid, corners);
+	const ug::vector3 offCenter(0.3, 0.2, -0.1);
+	ug::Vertex* center = *grid.create<ug::RegularVertex>();
+	aaPos[center] = offCenter;
+	for (size_t x = 0; x < 2; x++) {
+		for (size_t y = 2; y < 4; y++) {
+			for (size_t z = 4; z < 6; z++) {
+				grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(center, corners[x], corners[y], corners[z]));
+			}
+		}
+	}
+
+	/// one corner is fixed by its subset, all of them by the boundary
+	sh.assign_subset(corners[0], 0);
+	std::vector<ug::vector3> cornerPos;
+	for (size_t i = 0; i < 6; i++) {
+		cornerPos.push_back(aaPos[corners[i]]);
+	}
+
+	ug::number qualityBefore = MinTetrahedronQuality(grid);
+	TetMeshOptimizer optimizer(grid, sh);
+	optimizer.optimize(1);
+	BOOST_CHECK_EQUAL(optimizer.num_colors(), 1u);
+	BOOST_CHECK_SMALL(ug::VecLength(aaPos[center]), 1e-12);
+	BOOST_CHECK_GT(optimizer.min_quality(), qualityBefore);
+	BOOST_CHECK_CLOSE(optimizer.min_quality(), MinTetrahedronQuality(grid), 1e-8);
+	for (size_t i = 0; i < 6; i++) {
+		BOOST_CHECK_EQUAL(ug::VecDistance(aaPos[corners[i]], cornerPos[i]), 0);
+	}
+
+	/// an inner vertex assigned to a subset (i.e. on an interface) stays
+	aaPos[center] = offCenter;
+	sh.assign_subset(center, 1);
+	optimizer.optimize(1);
+	BOOST_CHECK_EQUAL(optimizer.num_colors(), 0u);
+	BOOST_CHECK_EQUAL(ug::VecDistance(aaPos[center], offCenter), 0);
+}
+
+/// adjacent inner vertices get different colors, quality never drops
+BOOST_AUTO_TEST_CASE(TET_MESH_OPTIMIZER_COLORING) {
+	ug::Grid grid(ug::GRIDOPT_STANDARD_INTERCONNECTION | ug::GRIDOPT_AUTOGENERATE_SIDES);
+	grid.attach_to_vertices(ug::aPosition);
+	ug::Grid::VertexAttachmentAccessor<ug::APosition> aaPos(grid, ug::aPosition);
+	ug::SubsetHandler sh(grid);
+
+	/// octahedron with inner vertices above and below the equatorial square:
+	/// cones over the upper and lower faces and a bipyramid around the square
+	ug::Vertex* corners[6];
+	CreateOctahedronCorners(grid, corners);
+	ug::Vertex* upper = *grid.create<ug::RegularVertex>();
+	ug::Vertex* lower = *grid.create<ug::RegularVertex>();
+	aaPos[upper] = ug::vector3(0.2, -0.1, 0.6);
+	aaPos[lower] = ug::vector3(-0.1, 0.05, -0.2);
+	ug::Vertex* square[4] = {corners[0], corners[2], corners[1], corners[3]};
+	for (size_t i = 0; i < 4; i++) {
+		ug::Vertex* c0 = square[i];
+		ug::Vertex* c1 = square[(i + 1) % 4];
+		grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(upper, corners[4], c0, c1));
+		grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(upper, lower, c0, c1));
+		grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(lower, corners[5], c0, c1));
+	}
+
+	ug::number qualityBefore = MinTetrahedronQuality(grid);
+	TetMeshOptimizer optimizer(grid, sh);
+	optimizer.optimize(5);
+	BOOST_CHECK_GE(optimizer.min_quality(), qualityBefore);
+
+	/// no two vertices of one color share a tetrahedron
+	BOOST_REQUIRE_EQUAL(optimizer.num_colors(), 2u);
+	for (size_t c = 0; c < optimizer.num_colors(); c++) {
+		std::vector<ug::Vertex*> vrts = optimizer.vertices_of_color(c);
+		BOOST_CHECK_EQUAL(vrts.size(), 1u);
+		for (ug::VolumeIterator vIter = grid.volumes_begin(); vIter != grid.volumes_end(); ++vIter) {
+			size_t numColored = 0;
+			for (size_t i = 0; i < (*vIter)->num_vertices(); i++) {
+				numColored += std::count(vrts.begin(), vrts.end(), (*vIter)->vertex(i));
+			}
+			BOOST_CHECK_LE(numColored, 1u);
+		}
+	}
+}
+
+/// 3-2 flip removes the inner edge of a tall bipyramid, 2-3 flip adds it to a flat one
+BOOST_AUTO_TEST_CASE(TET_MESH_OPTIMIZER_FLIPS) {
+	for (size_t flat = 0; flat < 2; flat++) {
+		ug::Grid grid(ug::GRIDOPT_STANDARD_INTERCONNECTION | ug::GRIDOPT_AUTOGENERATE_SIDES);
+		grid.attach_to_vertices(ug::aPosition);
+		ug::SubsetHandler sh(grid);
+		ug::Vertex* vrts[5];
+		CreateBipyramidCorners(grid, flat ? 0.2 : 2, vrts);
+		if (flat) {
+			grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(vrts[0], vrts[1], vrts[2], vrts[3]));
+			grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(vrts[0], vrts[1], vrts[2], vrts[4]));
+		} else {
+			for (size_t i = 0; i < 3; i++) {
+				grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(vrts[3], vrts[4], vrts[i], vrts[(i + 1) % 3]));
+			}
+		}
+
+		ug::number qualityBefore = MinTetrahedronQuality(grid);
+		TetMeshOptimizer optimizer(grid, sh);
+		optimizer.optimize(1);
+		BOOST_CHECK_EQUAL(optimizer.num_flips(), 1u);
+		BOOST_CHECK_GT(optimizer.min_quality(), qualityBefore);
+		BOOST_CHECK_CLOSE(optimizer.min_quality(), MinTetrahedronQuality(grid), 1e-8);
+
+		/// 6 outer faces and 9 outer edges stay, inner sides are replaced
+		BOOST_CHECK_EQUAL(grid.num_volumes(), flat ? 3u : 2u);
+		BOOST_CHECK_EQUAL(grid.num_faces(), flat ? 9u : 7u);
+		BOOST_CHECK_EQUAL(grid.num_edges(), flat ? 10u : 9u);
+		BOOST_CHECK_EQUAL(grid.get_edge(vrts[3], vrts[4]) != NULL, flat == 1);
+	}
+}
+
+/// faces of interfaces and tetrahedra of different subsets are never flipped
+BOOST_AUTO_TEST_CASE(TET_MESH_OPTIMIZER_FLIP_CONSTRAINTS) {
+	for (size_t constraint = 0; constraint < 2; constraint++) {
+		ug::Grid grid(ug::GRIDOPT_STANDARD_INTERCONNECTION | ug::GRIDOPT_AUTOGENERATE_SIDES);
+		grid.attach_to_vertices(ug::aPosition);
+		ug::SubsetHandler sh(grid);
+		ug::Vertex* vrts[5];
+		CreateBipyramidCorners(grid, 0.2, vrts);
+		ug::Volume* upper = *grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(vrts[0], vrts[1], vrts[2], vrts[3]));
+		ug::Volume* lower = *grid.create<ug::Tetrahedron>(ug::TetrahedronDescriptor(vrts[0], vrts[1], vrts[2], vrts[4]));
+		if (constraint == 0) {
+			ug::FaceDescriptor fd(vrts[0], vrts[1], vrts[2]);
+			ug::Face* shared = grid.get_face(fd);
+			BOOST_REQUIRE(shared);
+			sh.assign_subset(shared, 0);
+		} else {
+			sh.assign_subset(upper, 0);
+			sh.assign_subset(lower, 1);
+		}
+
+		TetMeshOptimizer optimizer(grid, sh);
+		optimizer.optimize(1);
+		BOOST_CHECK_EQUAL(optimizer.num_flips(), 0u);
+		BOOST_CHECK_EQUAL(grid.num_volumes(), 2u);
+		BOOST_CHECK_EQUAL(grid.num_faces(), 7u);
+	}
+}
+
+/// top cap is triangulated exactly once, i.e. covers the outer ring once
+BOOST_AUTO_TEST_CASE(TOP_SURFACE) {
+	SkinLayerGenerator slg;
+	AddTestStack(slg);
+	slg.generate();
+
+	ug::Grid grid;
+	ug::SubsetHandler sh(grid);
+	BOOST_REQUIRE(ug::LoadGridFromFile(grid, sh, "skin_layer_generator_step3.ugx"));
+
+	/// default outer ring: 10 vertices on the unit circle
+	ug::number ringArea = 5 * std::sin(2 * M_PI / 10);
+	BOOST_CHECK_CLOSE(AreaAtHeight(grid, 0), ringArea, 1e-6);
+	BOOST_CHECK_CLOSE(AreaAtHeight(grid, TEST_STACK_HEIGHT), ringArea, 1e-6);
+}
+
+/// preview is fast and yields the labeled surface mesh with the layout of a full run
+BOOST_AUTO_TEST_CASE(PREVIEW) {
+	SkinLayerGenerator full;
+	AddTestStack(full);
+	full.generate();
+	SmartPtr<MeshStatistics> fullStats = full.statistics();
+
+	SkinLayerGenerator preview;
+	AddTestStack(preview);
+	preview.set_preview(true);
+	std::clock_t start = std::clock();
+	preview.generate();
+	double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+	BOOST_CHECK_LT(seconds, 1.0);
+	SmartPtr<MeshStatistics> previewStats = preview.statistics();
+
+	/// layers appear bottom to top in both
+	const char* layers[] = {"Epidermis", "Dermis", "Hypodermis"};
+	for (size_t i = 0; i < 3; i++) {
+		BOOST_CHECK_NE(fullStats->subset_index(layers[i]), -1);
+		BOOST_CHECK_NE(previewStats->subset_index(layers[i]), -1);
+	}
+	for (size_t i = 0; i < 2; i++) {
+		BOOST_CHECK_LT(fullStats->subset_index(layers[i]), fullStats->subset_index(layers[i+1]));
+		BOOST_CHECK_LT(previewStats->subset_index(layers[i]), previewStats->subset_index(layers[i+1]));
+	}
+
+	/// the preview ends after Step IV: the lateral surface is labeled by the
+	/// layers, the caps by their own subsets, "Surface" exists in the full run only
+	const char* previewOnly[] = {"Depot", "Bottom Surface", "Top Surface"};
+	for (size_t i = 0; i < 3; i++) {
+		BOOST_CHECK_NE(previewStats->subset_index(previewOnly[i]), -1);
+	}
+	BOOST_CHECK_EQUAL(previewStats->subset_index("Surface"), -1);
+	BOOST_CHECK_NE(fullStats->subset_index("Surface"), -1);
+
+	/// surface mesh only
+	ug::Grid grid;
+	ug::SubsetHandler sh(grid);
+	BOOST_REQUIRE(ug::LoadGridFromFile(grid, sh, "skin_layer_generator_preview.ugx"));
+	BOOST_CHECK_EQUAL(static_cast<size_t>(sh.num_subsets()), previewStats->num_subsets());
+	BOOST_CHECK_GT(grid.num_faces(), 0u);
+	BOOST_CHECK_EQUAL(grid.num_volumes(), 0u);
+	for (size_t si = 0; si < previewStats->num_subsets(); si++) {
+		BOOST_CHECK_EQUAL(previewStats->num_volumes(si), 0u);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END();